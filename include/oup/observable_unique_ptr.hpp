@@ -26,6 +26,9 @@ class basic_observer_ptr;
 template<typename T, typename Policy>
 class basic_enable_observer_from_this;
 
+template<typename T, typename Policy>
+class basic_observer_flat_set;
+
 template<typename T, typename Policy, typename... Args>
 auto make_observable(Args&&... args);
 
@@ -82,6 +85,13 @@ constexpr std::size_t floor_log2(std::size_t x) {
 constexpr std::size_t ceil_log2(std::size_t x) {
     return x == 1 ? 0 : 1 + floor_log2(x - 1);
 }
+
+// Offset of the object within a single-allocation buffer, where the control block
+// is placed first and the object follows with its own alignment.
+template<typename Block, typename Object>
+constexpr std::size_t sealed_object_offset() noexcept {
+    return alignof(Object) * (1 + (sizeof(Block) - 1) / alignof(Object));
+}
 } // namespace details
 
 /**
@@ -222,6 +232,9 @@ class basic_control_block final {
     template<typename P>
     friend struct details::enable_observer_from_this_base;
 
+    template<typename T, typename P>
+    friend class oup::basic_observer_flat_set;
+
     template<typename U, typename P, typename... Args>
     friend auto oup::make_observable(Args&&... args);
 
@@ -260,6 +273,10 @@ class basic_control_block final {
         return (storage ^ highest_bit_mask) == 0;
     }
 
+    control_block_storage_type ref_count() const noexcept {
+        return storage & ~highest_bit_mask;
+    }
+
     bool expired() const noexcept {
         return (storage & highest_bit_mask) != 0;
     }
@@ -441,6 +458,60 @@ private:
         }
     }
 
+    /// Deleter used by @ref make_observable for this policy.
+    using make_observable_deleter = std::conditional_t<
+        queries::make_observer_single_allocation(),
+        placement_delete,
+        default_delete>;
+
+    /// Storage of the object in the buffer allocated by @ref make_observable, if sealed.
+    std::byte* object_storage_() const noexcept {
+        return reinterpret_cast<std::byte*>(block) +
+               details::sealed_object_offset<control_block_type, std::remove_cv_t<T>>();
+    }
+
+    /**
+     * \brief Check whether the control block of the owned object can be reused for a new object.
+     * \note This requires that no @ref basic_observer_ptr is observing the object. If the policy
+     * is sealed, the object must also be located where @ref make_observable would construct a
+     * `T`, so its storage can be reused as well.
+     */
+    bool can_reuse_block_() const noexcept {
+        if (ptr_deleter.pointer() == nullptr) {
+            return false;
+        }
+
+        if constexpr (queries::make_observer_single_allocation()) {
+            // The reference held by basic_enable_observer_from_this goes away with the object.
+            constexpr std::size_t object_refs = has_enable_observer_from_this<T, Policy> ? 2 : 1;
+            return block->ref_count() == object_refs &&
+                   static_cast<const void*>(ptr_deleter.pointer()) == object_storage_();
+        } else {
+            return block->ref_count() == 1;
+        }
+    }
+
+    /// Construct a new object in the storage of the old one (sealed only).
+    template<typename... Args>
+    T* construct_in_storage_(Args&&... args) {
+        using object_type = std::remove_cv_t<T>;
+
+        if constexpr (
+            has_enable_observer_from_this<object_type, Policy> &&
+            queries::eoft_base_constructor_needs_block()) {
+            return new (object_storage_()) object_type(*block, std::forward<Args>(args)...);
+        } else {
+            object_type* ptr = new (object_storage_()) object_type(std::forward<Args>(args)...);
+
+            if constexpr (has_enable_observer_from_this<object_type, Policy>) {
+                // Notify basic_enable_observer_from_this of the control
+                ptr->set_control_block_(block);
+            }
+
+            return ptr;
+        }
+    }
+
     /**
      * \brief Decide whether to allocate a new control block or not.
      * \note If the object inherits from @ref basic_enable_observer_from_this, and
@@ -501,6 +572,10 @@ private:
     template<typename U, typename D, typename P>
     friend class basic_observable_ptr;
 
+    // Friendship is required for control block identity.
+    template<typename U, typename P>
+    friend class basic_observer_flat_set;
+
 public:
     /// Default constructor (null pointer).
     basic_observable_ptr() noexcept = default;
@@ -796,6 +871,85 @@ public:
         }
     }
 
+    /**
+     * \brief Replaces the managed object with a newly constructed object.
+     * \param args Arguments to construct the new object
+     * \details This has the same effect as `*this = make_observable<T, Policy>(args...)`, but
+     * avoids memory allocations when possible. The control block is reused for the new object
+     * if this pointer holds its only reference; if `Policy::is_sealed` is true, a single
+     * reference held by the @ref basic_enable_observer_from_this base of `T` is also allowed.
+     * If `Policy::is_sealed` is true, the old object is then destroyed first, and the new object
+     * is constructed in its storage, so no allocation takes place. Otherwise, the new object is
+     * allocated and constructed first, and the old object is deleted afterwards. If the
+     * control block cannot be reused, the new object is created with @ref make_observable,
+     * and existing observer pointers will be marked as expired when the old object is destroyed.
+     * \note The control block is never reused (and this function allocates) if:
+     *  - the managed object is observed by any @ref basic_observer_ptr, including one stored
+     *    in the object itself,
+     *  - `Policy::is_sealed` is true and the object has more than one
+     *    @ref basic_enable_observer_from_this base,
+     *  - `Policy::is_sealed` is true and the managed pointer does not point to the start of
+     *    the object storage (e.g., the object was created by `make_observable<U>()` with `U`
+     *    a type derived from `T`, stored at a different offset),
+     *  - `Policy::is_sealed` is false and `T` inherits from @ref basic_enable_observer_from_this.
+     * \note This function requires `Deleter` to be the deleter used by @ref make_observable.
+     * \note If `Policy::is_sealed` is true, `args` must not refer to the managed object (or
+     * anything it owns), since it may be destroyed before the new object is constructed.
+     * \note If `Policy::is_sealed` is true, the control block is reused, and the constructor of
+     * the new object throws, the old object has already been destroyed and this pointer is
+     * left null. Otherwise, this pointer is left unchanged.
+     */
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        static_assert(
+            std::is_same_v<Deleter, make_observable_deleter>,
+            "emplace() requires the deleter used by make_observable()");
+
+        if constexpr (queries::make_observer_single_allocation()) {
+            if (can_reuse_block_()) {
+                // Nobody is observing the old object; destroy it but keep the control block
+                // (this follows `std::unique_ptr` specs: detach first, then delete)
+                T* old_ptr            = ptr_deleter.pointer();
+                ptr_deleter.pointer() = nullptr;
+                ptr_deleter.deleter()(old_ptr);
+                block->set_not_expired();
+
+                try {
+                    ptr_deleter.pointer() = construct_in_storage_(std::forward<Args>(args)...);
+                } catch (...) {
+                    // Exception thrown during object construction,
+                    // release the control block and let exception propagate
+                    block->set_expired();
+                    block->pop_ref();
+                    block = nullptr;
+                    throw;
+                }
+
+                return;
+            }
+        } else if constexpr (!has_enable_observer_from_this<T, Policy>) {
+            if (can_reuse_block_()) {
+                // Storage is not reused, so the new object can be constructed first
+                T* new_ptr = new std::remove_cv_t<T>(std::forward<Args>(args)...);
+
+                if (block->ref_count() != 1) {
+                    // The new object started observing the old one; it must expire normally
+                    *this = basic_observable_ptr(new_ptr);
+                    return;
+                }
+
+                // Nobody is observing the old object; delete it but keep the control block
+                T* old_ptr            = ptr_deleter.pointer();
+                ptr_deleter.pointer() = new_ptr;
+                ptr_deleter.deleter()(old_ptr);
+
+                return;
+            }
+        }
+
+        *this = make_observable<T, Policy>(std::forward<Args>(args)...);
+    }
+
     /**
      * \brief Releases ownership of the managed object.
      * \return A pointer to the un-managed object
@@ -922,11 +1076,11 @@ auto make_observable(Args&&... args) {
         }
     } else {
         // Pre-allocate memory, properly aligned for both the control block and the object
-        constexpr std::size_t block_size  = sizeof(control_block_type);
         constexpr std::size_t block_align = alignof(control_block_type);
         constexpr std::size_t obj_size    = sizeof(object_type);
         constexpr std::size_t obj_align   = alignof(object_type);
-        constexpr std::size_t obj_offset  = obj_align * (1 + (block_size - 1) / obj_align);
+        constexpr std::size_t obj_offset =
+            details::sealed_object_offset<control_block_type, object_type>();
 
         // See comment below on alignment
         static_assert(
@@ -1051,6 +1205,9 @@ private:
     // Friendship is required for basic_enable_observer_from_this.
     template<typename U, typename P>
     friend class basic_enable_observer_from_this;
+    // Friendship is required for control block identity.
+    template<typename U, typename P>
+    friend class basic_observer_flat_set;
 
     control_block_type* block = nullptr;
     T*                  data  = nullptr;
@@ -0,0 +1,508 @@
+#ifndef OBSERVABLE_UNIQUE_PTR_OBSERVER_FLAT_SET_INCLUDED
+#define OBSERVABLE_UNIQUE_PTR_OBSERVER_FLAT_SET_INCLUDED
+
+#include "oup/observable_unique_ptr.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace oup {
+
+/**
+ * \brief Sorted set of observer pointers, ordered by identity of the observed object.
+ * \details Members are identified by their control block: two observers of the same object
+ * are the same member, even if one of them has expired, or if they point to different
+ * sub-objects. The set only compares control block addresses, and never reads the control
+ * blocks themselves, so membership tests are a binary search over a contiguous array of
+ * addresses. The observed raw pointers are stored in a separate array.
+ *
+ * Expired members are not removed automatically; they remain in the set (and keep their
+ * control block alive, like any observer pointer) until @ref erase_expired() is called.
+ * This allows removing them in bulk, at a time of your choosing.
+ *
+ * \note Contrary to `operator==` on @ref basic_observer_ptr, expired members are not equal
+ * to each other, nor to a null pointer. Null observer pointers are never inserted.
+ * \see observer_flat_set
+ * \see basic_observer_ptr
+ */
+template<typename T, typename Policy>
+class basic_observer_flat_set final {
+public:
+    /// Policy for the control block
+    using observer_policy = Policy;
+
+    /// Type of the control block
+    using control_block_type = basic_control_block<observer_policy>;
+
+    /// Type of the pointed object
+    using element_type = T;
+
+    /// Type of the observer pointers in the set
+    using observer_type = basic_observer_ptr<T, observer_policy>;
+
+    /// Type for sizes and indices
+    using size_type = std::size_t;
+
+private:
+    // Sorted by address; this is the only array accessed when searching.
+    std::vector<control_block_type*> blocks;
+    // Observed pointers, in the same order as `blocks`.
+    std::vector<T*> data;
+
+    static std::uintptr_t key_(const control_block_type* b) noexcept {
+        return reinterpret_cast<std::uintptr_t>(b);
+    }
+
+    /**
+     * \brief Find the position of the first member not ordered before `key`.
+     * \note The loop runs a fixed number of iterations for a given size, and the comparison
+     * is only used to select the next base, which compilers turn into a conditional move.
+     */
+    size_type lower_bound_(std::uintptr_t key) const noexcept {
+        if (blocks.empty()) {
+            return 0;
+        }
+
+        control_block_type* const* base = blocks.data();
+        size_type                  n    = blocks.size();
+        while (n > 1) {
+            const size_type half = n / 2;
+            base                 = key_(base[half]) < key ? base + half : base;
+            n -= half;
+        }
+
+        return static_cast<size_type>(base - blocks.data()) + (key_(*base) < key ? 1 : 0);
+    }
+
+    template<typename U>
+    static std::pair<control_block_type*, T*>
+    identity_(const basic_observer_ptr<U, Policy>& value) noexcept {
+        return {value.block, value.data};
+    }
+
+    template<typename U, typename D, typename P>
+    static std::pair<control_block_type*, T*>
+    identity_(const basic_observable_ptr<U, D, P>& owner) noexcept {
+        return {owner.block, owner.ptr_deleter.pointer()};
+    }
+
+    size_type find_(const control_block_type* b) const noexcept {
+        const size_type i = lower_bound_(key_(b));
+        return i != blocks.size() && blocks[i] == b ? i : blocks.size();
+    }
+
+    void reserve_for_insert_(size_type count) {
+        const size_type new_size = blocks.size() + count;
+        if (new_size > blocks.capacity()) {
+            const size_type new_capacity = std::max(new_size, 2 * blocks.capacity());
+            blocks.reserve(new_capacity);
+            data.reserve(new_capacity);
+        } else if (new_size > data.capacity()) {
+            data.reserve(blocks.capacity());
+        }
+    }
+
+    bool insert_(control_block_type* b, T* d) {
+        if (b == nullptr) {
+            return false;
+        }
+
+        const size_type i = lower_bound_(key_(b));
+        if (i != blocks.size() && blocks[i] == b) {
+            return false;
+        }
+
+        // Reserve first; inserting pointers into reserved vectors cannot throw.
+        reserve_for_insert_(1);
+        blocks.insert(blocks.begin() + i, b);
+        data.insert(data.begin() + i, d);
+        b->push_ref();
+        return true;
+    }
+
+    bool erase_(const control_block_type* b) noexcept {
+        if (b == nullptr) {
+            return false;
+        }
+
+        const size_type i = find_(b);
+        if (i == blocks.size()) {
+            return false;
+        }
+
+        control_block_type* old_block = blocks[i];
+        blocks.erase(blocks.begin() + i);
+        data.erase(data.begin() + i);
+        old_block->pop_ref();
+        return true;
+    }
+
+    /**
+     * \brief Merge sorted, unique members into this set.
+     * \param other_blocks The control blocks to merge (sorted, without duplicates)
+     * \param other_data The observed pointers to merge
+     * \param adopt_refs If `true`, the references held by `other_blocks` are transferred to
+     * this set. Otherwise, new references are taken.
+     */
+    template<typename U>
+    void merge_(
+        const std::vector<control_block_type*>& other_blocks,
+        const std::vector<U*>&                  other_data,
+        bool                                    adopt_refs) {
+
+        std::vector<control_block_type*> new_blocks;
+        std::vector<T*>                  new_data;
+        new_blocks.reserve(blocks.size() + other_blocks.size());
+        new_data.reserve(blocks.size() + other_blocks.size());
+
+        // No allocation below this point, so this cannot fail.
+        size_type i = 0;
+        size_type j = 0;
+        while (i < blocks.size() || j < other_blocks.size()) {
+            if (j == other_blocks.size() ||
+                (i < blocks.size() && key_(blocks[i]) < key_(other_blocks[j]))) {
+                new_blocks.push_back(blocks[i]);
+                new_data.push_back(data[i]);
+                ++i;
+            } else if (i == blocks.size() || key_(other_blocks[j]) < key_(blocks[i])) {
+                new_blocks.push_back(other_blocks[j]);
+                new_data.push_back(other_data[j]);
+                if (!adopt_refs) {
+                    other_blocks[j]->push_ref();
+                }
+                ++j;
+            } else {
+                // Already a member.
+                new_blocks.push_back(blocks[i]);
+                new_data.push_back(data[i]);
+                if (adopt_refs) {
+                    other_blocks[j]->pop_ref();
+                }
+                ++i;
+                ++j;
+            }
+        }
+
+        blocks.swap(new_blocks);
+        data.swap(new_data);
+    }
+
+public:
+    /// Default constructor (empty set).
+    basic_observer_flat_set() noexcept = default;
+
+    /// Destructor, releases all members.
+    ~basic_observer_flat_set() noexcept {
+        clear();
+    }
+
+    /**
+     * \brief Copy an existing @ref basic_observer_flat_set instance
+     * \param value The existing set to copy
+     */
+    basic_observer_flat_set(const basic_observer_flat_set& value) :
+        blocks(value.blocks), data(value.data) {
+        for (control_block_type* b : blocks) {
+            b->push_ref();
+        }
+    }
+
+    /**
+     * \brief Move from an existing @ref basic_observer_flat_set instance
+     * \param value The existing set to move from
+     * \note After this @ref basic_observer_flat_set is created, the source set is empty.
+     */
+    basic_observer_flat_set(basic_observer_flat_set&& value) noexcept :
+        blocks(std::move(value.blocks)), data(std::move(value.data)) {
+        value.blocks.clear();
+        value.data.clear();
+    }
+
+    /**
+     * \brief Copy an existing @ref basic_observer_flat_set instance
+     * \param value The existing set to copy
+     */
+    basic_observer_flat_set& operator=(const basic_observer_flat_set& value) {
+        if (&value == this) {
+            return *this;
+        }
+
+        basic_observer_flat_set copy(value);
+        swap(copy);
+        return *this;
+    }
+
+    /**
+     * \brief Move from an existing @ref basic_observer_flat_set instance
+     * \param value The existing set to move from
+     * \note After the assignment is complete, the source set is empty.
+     */
+    basic_observer_flat_set& operator=(basic_observer_flat_set&& value) noexcept {
+        if (&value == this) {
+            return *this;
+        }
+
+        clear();
+        blocks.swap(value.blocks);
+        data.swap(value.data);
+        return *this;
+    }
+
+    /**
+     * \brief Swap the content of this set with that of another set.
+     * \param other The other set to swap with
+     */
+    void swap(basic_observer_flat_set& other) noexcept {
+        blocks.swap(other.blocks);
+        data.swap(other.data);
+    }
+
+    /// Number of members, including expired members.
+    size_type size() const noexcept {
+        return blocks.size();
+    }
+
+    /// Check if the set has no member (not even expired).
+    bool empty() const noexcept {
+        return blocks.empty();
+    }
+
+    /**
+     * \brief Pre-allocate memory for a given number of members.
+     * \param capacity The number of members to allocate memory for
+     */
+    void reserve(size_type capacity) {
+        blocks.reserve(capacity);
+        data.reserve(capacity);
+    }
+
+    /// Remove all members.
+    void clear() noexcept {
+        for (control_block_type* b : blocks) {
+            b->pop_ref();
+        }
+
+        blocks.clear();
+        data.clear();
+    }
+
+    /**
+     * \brief Check if an object is a member of this set.
+     * \param value An observer pointer to the object
+     * \return `true` if the object is a member, `false` otherwise (or if `value` is null)
+     * \note This does not check if the object has expired.
+     */
+    template<typename U>
+    bool contains(const basic_observer_ptr<U, Policy>& value) const noexcept {
+        return value.block != nullptr && find_(value.block) != blocks.size();
+    }
+
+    /**
+     * \brief Check if an object is a member of this set.
+     * \param owner The owner pointer of the object
+     * \return `true` if the object is a member, `false` otherwise (or if `owner` is null)
+     */
+    template<
+        typename U,
+        typename D,
+        typename P,
+        typename enable = std::enable_if_t<std::is_same_v<Policy, typename P::observer_policy>>>
+    bool contains(const basic_observable_ptr<U, D, P>& owner) const noexcept {
+        return owner.block != nullptr && find_(owner.block) != blocks.size();
+    }
+
+    /**
+     * \brief Add an object to this set.
+     * \param value An observer pointer to the object
+     * \return `true` if the object was added, `false` if it was already a member or if
+     * `value` is null
+     * \note Expired observer pointers can be inserted. This operator only takes part in
+     * overload resolution if `U*` is convertible to `T*`.
+     */
+    template<typename U, typename enable = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    bool insert(const basic_observer_ptr<U, Policy>& value) {
+        return insert_(value.block, value.data);
+    }
+
+    /**
+     * \brief Add an object to this set.
+     * \param owner The owner pointer of the object
+     * \return `true` if the object was added, `false` if it was already a member or if
+     * `owner` is null
+     * \note This operator only takes part in overload resolution if `U*` is convertible
+     * to `T*`.
+     */
+    template<
+        typename U,
+        typename D,
+        typename P,
+        typename enable = std::enable_if_t<
+            std::is_convertible_v<U*, T*> && std::is_same_v<Policy, typename P::observer_policy>>>
+    bool insert(const basic_observable_ptr<U, D, P>& owner) {
+        return insert_(owner.block, owner.ptr_deleter.pointer());
+    }
+
+    /**
+     * \brief Add multiple objects to this set.
+     * \param first Iterator to the first observer or owner pointer to add
+     * \param last Iterator past the last observer or owner pointer to add
+     * \note The new members are sorted separately, then merged with the existing members in
+     * a single pass. This is faster than calling @ref insert() for each of them.
+     */
+    template<typename Iterator>
+    void insert(Iterator first, Iterator last) {
+        std::vector<std::pair<control_block_type*, T*>> added;
+        if constexpr (std::is_base_of_v<
+                          std::forward_iterator_tag,
+                          typename std::iterator_traits<Iterator>::iterator_category>) {
+            added.reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+
+        for (; first != last; ++first) {
+            auto member = identity_(*first);
+            if (member.first != nullptr) {
+                added.push_back(member);
+            }
+        }
+
+        std::sort(added.begin(), added.end(), [](const auto& a, const auto& b) {
+            return key_(a.first) < key_(b.first);
+        });
+
+        std::vector<control_block_type*> added_blocks;
+        std::vector<T*>                  added_data;
+        added_blocks.reserve(added.size());
+        added_data.reserve(added.size());
+        for (const auto& [b, d] : added) {
+            if (added_blocks.empty() || added_blocks.back() != b) {
+                added_blocks.push_back(b);
+                added_data.push_back(d);
+            }
+        }
+
+        merge_(added_blocks, added_data, false);
+    }
+
+    /**
+     * \brief Add all the members of another set to this set.
+     * \param other The set to merge into this set
+     * \note This is done in a single pass over both sets.
+     */
+    template<typename U, typename enable = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    void merge(const basic_observer_flat_set<U, Policy>& other) {
+        if constexpr (std::is_same_v<U, T>) {
+            if (&other == this) {
+                return;
+            }
+        }
+
+        merge_(other.blocks, other.data, false);
+    }
+
+    /**
+     * \brief Move all the members of another set to this set.
+     * \param other The set to merge into this set
+     * \note This is done in a single pass over both sets. After the merge is complete,
+     * the source set is empty.
+     */
+    template<typename U, typename enable = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    void merge(basic_observer_flat_set<U, Policy>&& other) {
+        if constexpr (std::is_same_v<U, T>) {
+            if (&other == this) {
+                return;
+            }
+        }
+
+        merge_(other.blocks, other.data, true);
+        other.blocks.clear();
+        other.data.clear();
+    }
+
+    /**
+     * \brief Remove an object from this set.
+     * \param value An observer pointer to the object
+     * \return `true` if the object was removed, `false` if it was not a member
+     */
+    template<typename U>
+    bool erase(const basic_observer_ptr<U, Policy>& value) noexcept {
+        return erase_(value.block);
+    }
+
+    /**
+     * \brief Remove an object from this set.
+     * \param owner The owner pointer of the object
+     * \return `true` if the object was removed, `false` if it was not a member
+     */
+    template<
+        typename U,
+        typename D,
+        typename P,
+        typename enable = std::enable_if_t<std::is_same_v<Policy, typename P::observer_policy>>>
+    bool erase(const basic_observable_ptr<U, D, P>& owner) noexcept {
+        return erase_(owner.block);
+    }
+
+    /**
+     * \brief Remove all expired members from this set.
+     * \return The number of members removed
+     * \note This is done in a single pass over the set, and preserves the order of the
+     * remaining members.
+     */
+    size_type erase_expired() noexcept {
+        size_type kept = 0;
+        for (size_type i = 0; i < blocks.size(); ++i) {
+            if (blocks[i]->expired()) {
+                blocks[i]->pop_ref();
+            } else {
+                blocks[kept] = blocks[i];
+                data[kept]   = data[i];
+                ++kept;
+            }
+        }
+
+        const size_type removed = blocks.size() - kept;
+        blocks.resize(kept);
+        data.resize(kept);
+        return removed;
+    }
+
+    /**
+     * \brief Get a non-owning raw pointer to a member, or `nullptr` if expired.
+     * \param index The index of the member, in [0, @ref size())
+     * \return `nullptr` if the member has expired, or the pointed object otherwise
+     * \note Members are ordered by control block address, which is unrelated to insertion order.
+     */
+    T* get(size_type index) const noexcept {
+        return blocks[index]->expired() ? nullptr : data[index];
+    }
+
+    /**
+     * \brief Get an observer pointer to a member.
+     * \param index The index of the member, in [0, @ref size())
+     * \return A new observer pointer to the member (which may be expired)
+     * \note Members are ordered by control block address, which is unrelated to insertion order.
+     */
+    observer_type operator[](size_type index) const noexcept {
+        return observer_type{blocks[index], data[index]};
+    }
+
+    // Friendship is required for merging sets of different types.
+    template<typename U, typename P>
+    friend class basic_observer_flat_set;
+};
+
+/**
+ * \brief Sorted set of @ref observer_ptr, ordered by identity of the observed object.
+ * \see basic_observer_flat_set
+ */
+template<typename T>
+using observer_flat_set = basic_observer_flat_set<T, default_observer_policy>;
+
+} // namespace oup
+
+#endif
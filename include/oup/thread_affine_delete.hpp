@@ -0,0 +1,217 @@
+#ifndef OBSERVABLE_UNIQUE_PTR_THREAD_AFFINE_DELETE_INCLUDED
+#define OBSERVABLE_UNIQUE_PTR_THREAD_AFFINE_DELETE_INCLUDED
+
+#include "oup/observable_unique_ptr.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace oup {
+
+namespace details {
+template<typename P>
+std::true_type inherits_eoft_base(const volatile enable_observer_from_this_base<P>*);
+std::false_type inherits_eoft_base(...);
+
+// Check if T inherits from basic_enable_observer_from_this, for any policy.
+template<typename T>
+constexpr bool has_any_enable_observer_from_this =
+    decltype(inherits_eoft_base(static_cast<T*>(nullptr)))::value;
+} // namespace details
+
+/**
+ * \brief Queue of objects waiting to be deleted on a specific thread.
+ * \details The queue records the thread it was created on (its "home" thread). Any thread
+ * may push objects into the queue, but only the home thread may delete them, by calling
+ * @ref drain(). Pushing is lock-free, and draining takes all pending objects at once.
+ * This is meant to be used with @ref thread_affine_delete.
+ * \note The queue must outlive all the @ref thread_affine_delete deleters referring to it.
+ * Pending objects are deleted when the queue is destroyed, which must therefore happen
+ * on the home thread.
+ */
+class deferred_delete_queue final {
+    struct node {
+        node* next = nullptr;
+        void* object = nullptr;
+        void (*destroy)(void*) noexcept = nullptr;
+    };
+
+    std::atomic<node*> head = nullptr;
+    std::thread::id    home = std::this_thread::get_id();
+
+public:
+    /// Default constructor, records the calling thread as the home thread.
+    deferred_delete_queue() noexcept = default;
+
+    /// Destructor, deletes all pending objects.
+    ~deferred_delete_queue() noexcept {
+        drain();
+    }
+
+    // Non-copyable, non-movable
+    deferred_delete_queue(const deferred_delete_queue&)            = delete;
+    deferred_delete_queue(deferred_delete_queue&&)                 = delete;
+    deferred_delete_queue& operator=(const deferred_delete_queue&) = delete;
+    deferred_delete_queue& operator=(deferred_delete_queue&&)      = delete;
+
+    /**
+     * \brief Return the thread on which queued objects are deleted.
+     * \return The identifier of the home thread
+     */
+    std::thread::id home_thread() const noexcept {
+        return home;
+    }
+
+    /**
+     * \brief Check if the calling thread is the home thread.
+     * \return `true` if called from the home thread, 'false' otherwise
+     */
+    bool on_home_thread() const noexcept {
+        return std::this_thread::get_id() == home;
+    }
+
+    /**
+     * \brief Queue an object for deletion on the home thread.
+     * \param ptr The object to delete (must have been allocated with `new`)
+     * \note This function can be called from any thread. It allocates a small node to
+     * hold the object in the queue; if this allocation fails, `std::bad_alloc` is thrown
+     * and the object is not queued.
+     */
+    template<typename T>
+    void push(T* ptr) {
+        static_assert(!std::is_same_v<T, void>, "cannot delete a pointer to an incomplete type");
+        static_assert(sizeof(T) > 0, "cannot delete a pointer to an incomplete type");
+
+        node* n    = new node;
+        n->object  = const_cast<void*>(static_cast<const volatile void*>(ptr));
+        n->destroy = [](void* p) noexcept { delete static_cast<T*>(p); };
+        n->next    = head.load(std::memory_order_relaxed);
+
+        while (!head.compare_exchange_weak(
+            n->next, n, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * \brief Delete all queued objects.
+     * \return The number of objects deleted
+     * \note This function must only be called from the home thread. Objects are deleted
+     * in the order in which they were queued. Objects queued while this function is
+     * running are left for the next call.
+     */
+    std::size_t drain() noexcept {
+        node* n = head.exchange(nullptr, std::memory_order_acquire);
+
+        // The queue is a stack; reverse it to delete objects in the order they were queued.
+        node* ordered = nullptr;
+        while (n != nullptr) {
+            node* next = n->next;
+            n->next    = ordered;
+            ordered    = n;
+            n          = next;
+        }
+
+        std::size_t count = 0;
+        while (ordered != nullptr) {
+            node* next = ordered->next;
+            ordered->destroy(ordered->object);
+            delete ordered;
+            ordered = next;
+            ++count;
+        }
+
+        return count;
+    }
+};
+
+/**
+ * \brief Deleter that only deletes objects on their home thread.
+ * \details When called on the home thread of its @ref deferred_delete_queue, this deleter
+ * deletes the object immediately, like @ref default_delete. When called on any other thread,
+ * the object is pushed into the queue instead, and will be deleted when the home thread calls
+ * @ref deferred_delete_queue::drain(). A default-constructed deleter has no queue, and always
+ * deletes immediately.
+ *
+ * When used with @ref observable_unique_ptr, observer pointers are marked as expired as soon
+ * as the owner pointer is reset or destroyed, even if the object itself is deleted later.
+ * This only defers the destructor: control blocks are still not thread-safe, so all
+ * observer pointers must live on the thread that resets or destroys the owner pointer.
+ * In particular, the home thread cannot observe the object if the owner pointer is
+ * released on another thread.
+ *
+ * \warning Since the destructor of a deferred object runs on the home thread, it must not
+ * release any owner or observer pointer (from this library) whose control block is used on
+ * another thread. For example, an object holding an observer pointer to an entity that is
+ * observed on the thread releasing the owner cannot be deleted with this deleter: destroying
+ * the member on the home thread would race with the other thread on the control block of
+ * the entity.
+ * \note This deleter cannot be used with sealed policies: the storage of the object is
+ * released together with the control block, which does not wait for the deferred deletion.
+ * \note Objects inheriting from @ref basic_enable_observer_from_this are rejected at compile
+ * time, since they hold a reference to their own control block. This is only a partial check
+ * of the rule above, for the static type of the pointer: other members holding pointers from
+ * this library, and a dynamic type inheriting from @ref basic_enable_observer_from_this, are
+ * not detected.
+ * \see make_observable_thread_affine
+ * \see deferred_delete_queue
+ */
+struct thread_affine_delete {
+    /// Queue of the home thread (can be null)
+    deferred_delete_queue* queue = nullptr;
+
+    /// Default constructor, objects are always deleted immediately.
+    thread_affine_delete() noexcept = default;
+
+    /**
+     * \brief Create a deleter bound to a home thread.
+     * \param q The queue of the home thread
+     */
+    explicit thread_affine_delete(deferred_delete_queue& q) noexcept : queue(&q) {}
+
+    /**
+     * \brief Delete an object, or queue it for deletion on the home thread.
+     * \param p The object to delete
+     * \note If queuing the object fails because of an allocation failure, `std::terminate`
+     * is called, since deleters are not allowed to throw.
+     */
+    template<typename T>
+    void operator()(T* p) const noexcept {
+        static_assert(
+            !details::has_any_enable_observer_from_this<T>,
+            "thread_affine_delete cannot delete objects inheriting from "
+            "basic_enable_observer_from_this");
+
+        if (queue == nullptr || queue->on_home_thread()) {
+            default_delete{}(p);
+        } else {
+            queue->push(p);
+        }
+    }
+};
+
+/**
+ * \brief Create a new @ref observable_unique_ptr whose object is deleted on the calling thread.
+ * \param queue The queue of the calling thread, used to defer deletions from other threads
+ * \param args Arguments to construct the new object
+ * \return The new observable_unique_ptr
+ * \note The calling thread should be the home thread of `queue`.
+ * \see thread_affine_delete
+ */
+template<typename T, typename... Args>
+observable_unique_ptr<T, thread_affine_delete>
+make_observable_thread_affine(deferred_delete_queue& queue, Args&&... args) {
+    static_assert(
+        !details::has_any_enable_observer_from_this<T>,
+        "thread_affine_delete cannot delete objects inheriting from "
+        "basic_enable_observer_from_this");
+
+    return observable_unique_ptr<T, thread_affine_delete>(
+        new std::remove_cv_t<T>(std::forward<Args>(args)...), thread_affine_delete{queue});
+}
+
+} // namespace oup
+
+#endif
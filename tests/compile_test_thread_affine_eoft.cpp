@@ -0,0 +1,8 @@
+#include "oup/thread_affine_delete.hpp"
+#include "tests_common.hpp"
+
+int main() {
+    oup::deferred_delete_queue queue;
+    auto ptr = oup::make_observable_thread_affine<test_object_observer_from_this_unique>(queue);
+    return 0;
+}
@@ -7,11 +7,12 @@
 volatile void*       allocations[max_allocations];
 volatile void*       allocations_array[max_allocations];
 volatile std::size_t allocations_bytes[max_allocations];
-volatile std::size_t num_allocations               = 0u;
-volatile std::size_t size_allocations              = 0u;
-volatile std::size_t double_delete                 = 0u;
-volatile bool        memory_tracking               = false;
-volatile bool        force_next_allocation_failure = false;
+volatile std::size_t num_allocations                   = 0u;
+volatile std::size_t size_allocations                  = 0u;
+volatile std::size_t double_delete                     = 0u;
+volatile bool        memory_tracking                   = false;
+volatile bool        force_next_allocation_failure     = false;
+volatile std::size_t allocations_before_forced_failure = 0u;
 
 constexpr bool debug_alloc    = false;
 constexpr bool scramble_alloc = true;
@@ -48,7 +49,9 @@ void* allocate(std::size_t size, bool array, std::align_val_t align) {
         throw std::bad_alloc();
     }
 
-    if (force_next_allocation_failure) {
+    if (force_next_allocation_failure && allocations_before_forced_failure > 0u) {
+        allocations_before_forced_failure = allocations_before_forced_failure - 1u;
+    } else if (force_next_allocation_failure) {
         if constexpr (debug_alloc) {
             std::printf("alloc   %zu failed\n", size);
         }
@@ -11,6 +11,7 @@ extern volatile std::size_t size_allocations;
 extern volatile std::size_t double_delete;
 extern volatile bool        memory_tracking;
 extern volatile bool        force_next_allocation_failure;
+extern volatile std::size_t allocations_before_forced_failure;
 
 void* operator new(std::size_t size);
 
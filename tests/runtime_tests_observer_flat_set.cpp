@@ -0,0 +1,356 @@
+#include "memory_tracker.hpp"
+#include "oup/observer_flat_set.hpp"
+#include "testing.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+template<typename T>
+using observer_set = oup::basic_observer_flat_set<get_object<T>, get_observer_policy<T>>;
+
+TEMPLATE_LIST_TEST_CASE("observer set default constructor", "[flat_set][observer]", owner_types) {
+    volatile memory_tracker mem_track;
+
+    {
+        TestType               ptr = make_pointer_deleter_1<TestType>();
+        observer_set<TestType> set;
+
+        CHECK(set.size() == 0u);
+        CHECK(set.empty());
+        CHECK(!set.contains(ptr));
+        CHECK(!set.contains(observer_ptr<TestType>{ptr}));
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEMPLATE_LIST_TEST_CASE("observer set insert", "[flat_set][observer]", owner_types) {
+    volatile memory_tracker mem_track;
+
+    {
+        TestType               ptr1 = make_pointer_deleter_1<TestType>();
+        TestType               ptr2 = make_pointer_deleter_2<TestType>();
+        TestType               ptr3 = make_pointer_deleter_1<TestType>();
+        observer_set<TestType> set;
+
+        CHECK(set.insert(ptr2));
+        CHECK(set.insert(observer_ptr<TestType>{ptr1}));
+        CHECK(!set.insert(ptr1));
+        CHECK(!set.insert(observer_ptr<TestType>{ptr2}));
+        CHECK(!set.insert(observer_ptr<TestType>{}));
+        CHECK(!set.insert(TestType{}));
+
+        CHECK(set.size() == 2u);
+        CHECK(set.contains(ptr1));
+        CHECK(set.contains(ptr2));
+        CHECK(!set.contains(ptr3));
+        CHECK(!set.contains(TestType{}));
+        CHECK(set.contains(observer_ptr<TestType>{ptr1}));
+        CHECK(!set.contains(observer_ptr<TestType>{ptr3}));
+        CHECK(!set.contains(observer_ptr<TestType>{}));
+
+        CHECK((set.get(0) == ptr1.get() || set.get(0) == ptr2.get()));
+        CHECK((set.get(1) == ptr1.get() || set.get(1) == ptr2.get()));
+        CHECK(set.get(0) != set.get(1));
+        CHECK(set[0].get() == set.get(0));
+        CHECK_INSTANCES(3, 3);
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEMPLATE_LIST_TEST_CASE("observer set erase", "[flat_set][observer]", owner_types) {
+    volatile memory_tracker mem_track;
+
+    {
+        TestType               ptr1 = make_pointer_deleter_1<TestType>();
+        TestType               ptr2 = make_pointer_deleter_2<TestType>();
+        observer_set<TestType> set;
+        set.insert(ptr1);
+        set.insert(ptr2);
+
+        CHECK(set.erase(ptr1));
+        CHECK(!set.erase(ptr1));
+        CHECK(!set.erase(observer_ptr<TestType>{}));
+        CHECK(set.size() == 1u);
+        CHECK(!set.contains(ptr1));
+        CHECK(set.contains(ptr2));
+
+        CHECK(set.erase(observer_ptr<TestType>{ptr2}));
+        CHECK(set.empty());
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEMPLATE_LIST_TEST_CASE("observer set expired", "[flat_set][observer]", owner_types) {
+    volatile memory_tracker mem_track;
+
+    {
+        TestType               ptr1 = make_pointer_deleter_1<TestType>();
+        TestType               ptr2 = make_pointer_deleter_2<TestType>();
+        observer_ptr<TestType> optr1{ptr1};
+        observer_set<TestType> set;
+        set.insert(ptr1);
+        set.insert(ptr2);
+
+        ptr1.reset();
+        CHECK(set.size() == 2u);
+        CHECK(set.contains(optr1));
+        CHECK(set.contains(ptr2));
+        CHECK((set.get(0) == nullptr || set.get(1) == nullptr));
+
+        CHECK(set.erase_expired() == 1u);
+        CHECK(set.size() == 1u);
+        CHECK(!set.contains(optr1));
+        CHECK(set.contains(ptr2));
+        CHECK(set.get(0) == ptr2.get());
+        CHECK(set.erase_expired() == 0u);
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEMPLATE_LIST_TEST_CASE("observer set expired outlives owner", "[flat_set][observer]", owner_types) {
+    volatile memory_tracker mem_track;
+
+    {
+        observer_set<TestType> set;
+
+        {
+            TestType ptr = make_pointer_deleter_1<TestType>();
+            set.insert(ptr);
+        }
+
+        CHECK(set.size() == 1u);
+        CHECK(set.get(0) == nullptr);
+        CHECK(set[0].expired());
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEMPLATE_LIST_TEST_CASE("observer set bulk insert", "[flat_set][observer]", owner_types) {
+    volatile memory_tracker mem_track;
+
+    {
+        TestType ptr1 = make_pointer_deleter_1<TestType>();
+        TestType ptr2 = make_pointer_deleter_2<TestType>();
+        TestType ptr3 = make_pointer_deleter_1<TestType>();
+
+        observer_set<TestType> set;
+        set.insert(ptr2);
+
+        observer_ptr<TestType> added[] = {
+            observer_ptr<TestType>{ptr3}, observer_ptr<TestType>{},
+            observer_ptr<TestType>{ptr2}, observer_ptr<TestType>{ptr1},
+            observer_ptr<TestType>{ptr3}};
+        set.insert(std::begin(added), std::end(added));
+
+        CHECK(set.size() == 3u);
+        CHECK(set.contains(ptr1));
+        CHECK(set.contains(ptr2));
+        CHECK(set.contains(ptr3));
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEMPLATE_LIST_TEST_CASE("observer set merge", "[flat_set][observer]", owner_types) {
+    volatile memory_tracker mem_track;
+
+    {
+        TestType ptr1 = make_pointer_deleter_1<TestType>();
+        TestType ptr2 = make_pointer_deleter_2<TestType>();
+        TestType ptr3 = make_pointer_deleter_1<TestType>();
+
+        observer_set<TestType> set1;
+        set1.insert(ptr1);
+        set1.insert(ptr2);
+
+        observer_set<TestType> set2;
+        set2.insert(ptr2);
+        set2.insert(ptr3);
+
+        set1.merge(set2);
+        CHECK(set1.size() == 3u);
+        CHECK(set1.contains(ptr1));
+        CHECK(set1.contains(ptr2));
+        CHECK(set1.contains(ptr3));
+        CHECK(set2.size() == 2u);
+
+        observer_set<TestType> set3;
+        set3.insert(ptr1);
+        set3.merge(std::move(set2));
+        CHECK(set3.size() == 3u);
+        CHECK(set3.contains(ptr1));
+        CHECK(set3.contains(ptr2));
+        CHECK(set3.contains(ptr3));
+        CHECK(set2.empty());
+
+        set3.merge(set3);
+        CHECK(set3.size() == 3u);
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEMPLATE_LIST_TEST_CASE("observer set copy and move", "[flat_set][observer]", owner_types) {
+    volatile memory_tracker mem_track;
+
+    {
+        TestType               ptr1 = make_pointer_deleter_1<TestType>();
+        TestType               ptr2 = make_pointer_deleter_2<TestType>();
+        observer_set<TestType> set1;
+        set1.insert(ptr1);
+        set1.insert(ptr2);
+
+        observer_set<TestType> set2(set1);
+        CHECK(set2.size() == 2u);
+        CHECK(set2.contains(ptr1));
+
+        observer_set<TestType> set3(std::move(set2));
+        CHECK(set2.empty());
+        CHECK(set3.size() == 2u);
+
+        set2 = set3;
+        CHECK(set2.size() == 2u);
+        set3 = std::move(set2);
+        CHECK(set2.empty());
+        CHECK(set3.size() == 2u);
+
+        set3.clear();
+        CHECK(set3.empty());
+        CHECK(set1.size() == 2u);
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEMPLATE_LIST_TEST_CASE("observer set many members", "[flat_set][observer]", owner_types) {
+    volatile memory_tracker mem_track;
+
+    {
+        constexpr std::size_t num_owners = 137u;
+
+        std::vector<TestType> owners;
+        owners.reserve(num_owners);
+        for (std::size_t i = 0; i < num_owners; ++i) {
+            owners.push_back(make_pointer_deleter_1<TestType>());
+        }
+
+        std::vector<std::size_t> order(num_owners);
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::mt19937 rng(1234u);
+
+        auto same_members = [&](const auto& set, const std::set<std::size_t>& expected) {
+            if (set.size() != expected.size()) {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < num_owners; ++i) {
+                if (set.contains(owners[i]) != (expected.count(i) != 0u)) {
+                    return false;
+                }
+            }
+
+            return true;
+        };
+
+        std::set<std::size_t> all;
+        for (std::size_t i = 0; i < num_owners; ++i) {
+            all.insert(i);
+        }
+
+        // Random insertions and removals
+        observer_set<TestType> set;
+        std::set<std::size_t>  expected;
+        for (std::size_t pass = 0; pass < 4; ++pass) {
+            std::shuffle(order.begin(), order.end(), rng);
+            for (std::size_t i : order) {
+                if (rng() % 3u != 0u) {
+                    CHECK(set.insert(owners[i]) == expected.insert(i).second);
+                } else {
+                    CHECK(set.erase(owners[i]) == (expected.erase(i) != 0u));
+                }
+            }
+
+            CHECK(same_members(set, expected));
+        }
+
+        // Merge overlapping sets
+        observer_set<TestType> low;
+        observer_set<TestType> high;
+        std::shuffle(order.begin(), order.end(), rng);
+        for (std::size_t i : order) {
+            if (i < 2u * num_owners / 3u) {
+                low.insert(owners[i]);
+            }
+            if (i >= num_owners / 3u) {
+                high.insert(observer_ptr<TestType>{owners[i]});
+            }
+        }
+
+        observer_set<TestType> merged_copy(low);
+        merged_copy.merge(high);
+        CHECK(same_members(merged_copy, all));
+        CHECK(high.size() == num_owners - num_owners / 3u);
+
+        observer_set<TestType> merged_move(high);
+        merged_move.merge(std::move(low));
+        CHECK(same_members(merged_move, all));
+        CHECK(low.empty());
+
+        // Bulk insert from owners
+        observer_set<TestType> bulk;
+        bulk.insert(owners.begin() + num_owners / 2u, owners.end());
+        bulk.insert(owners.begin(), owners.begin() + 2u * num_owners / 3u);
+        CHECK(same_members(bulk, all));
+
+        // Merge into a set of the base type
+        if constexpr (has_base<TestType>) {
+            oup::basic_observer_flat_set<get_base_object<TestType>, get_observer_policy<TestType>>
+                base_set;
+            for (std::size_t i = 0; i < num_owners / 3u; ++i) {
+                base_set.insert(owners[i]);
+            }
+
+            observer_set<TestType> derived_set(merged_copy);
+            base_set.merge(std::move(derived_set));
+            CHECK(same_members(base_set, all));
+            CHECK(derived_set.empty());
+        }
+
+        // Remove interleaved expired members
+        std::set<std::size_t> alive;
+        for (std::size_t i = 0; i < num_owners; ++i) {
+            if (i % 3u == 1u) {
+                owners[i].reset();
+            } else {
+                alive.insert(i);
+            }
+        }
+
+        CHECK(merged_copy.erase_expired() == num_owners - alive.size());
+        CHECK(same_members(merged_copy, alive));
+
+        // The remaining members must be in the same order as in a freshly sorted set
+        observer_set<TestType> fresh;
+        std::shuffle(order.begin(), order.end(), rng);
+        for (std::size_t i : order) {
+            fresh.insert(owners[i]);
+        }
+
+        REQUIRE(fresh.size() == merged_copy.size());
+        bool same_order = true;
+        for (std::size_t k = 0; k < fresh.size(); ++k) {
+            same_order = same_order && fresh.get(k) == merged_copy.get(k);
+        }
+        CHECK(same_order);
+    }
+
+    CHECK_NO_LEAKS;
+}
@@ -1,6 +1,8 @@
 #include "memory_tracker.hpp"
 #include "testing.hpp"
 
+#include <string>
+
 TEMPLATE_LIST_TEST_CASE("owner size", "[size][owner]", owner_types) {
     using deleter_type = get_deleter<TestType>;
 
@@ -93,6 +95,148 @@ TEMPLATE_LIST_TEST_CASE("owner reset to new bad alloc", "[reset][owner]", owner_
     }
 }
 
+TEMPLATE_LIST_TEST_CASE("owner emplace empty", "[emplace][owner]", owner_types) {
+    if constexpr (can_use_make_observable<TestType>) {
+        volatile memory_tracker mem_track;
+
+        {
+            TestType ptr;
+            ptr.emplace(test_object::state::special_init);
+
+            CHECK(ptr.get() != nullptr);
+            CHECK(ptr->state_ == test_object::state::special_init);
+            CHECK_INSTANCES(1, 1);
+        }
+
+        CHECK_NO_LEAKS;
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("owner emplace valid", "[emplace][owner]", owner_types) {
+    if constexpr (can_use_make_observable<TestType>) {
+        volatile memory_tracker mem_track;
+
+        {
+            TestType ptr          = make_pointer_deleter_1<TestType>();
+            auto*    raw_ptr_orig = ptr.get();
+            ptr.emplace(test_object::state::special_init);
+
+            CHECK(ptr.get() != nullptr);
+            if constexpr (can_emplace_reusing_block<TestType> && is_sealed<TestType>) {
+                CHECK(ptr.get() == raw_ptr_orig);
+            }
+            CHECK(ptr->state_ == test_object::state::special_init);
+            CHECK_INSTANCES(1, 1);
+        }
+
+        CHECK_NO_LEAKS;
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("owner emplace valid no alloc", "[emplace][owner]", owner_types) {
+    if constexpr (can_emplace_reusing_block<TestType> && is_sealed<TestType>) {
+        volatile memory_tracker mem_track;
+
+        {
+            TestType ptr                  = make_pointer_deleter_1<TestType>();
+            force_next_allocation_failure = true;
+            ptr.emplace(test_object::state::special_init);
+            force_next_allocation_failure = false;
+
+            CHECK(ptr.get() != nullptr);
+            CHECK(ptr->state_ == test_object::state::special_init);
+            CHECK_INSTANCES(1, 1);
+        }
+
+        CHECK_NO_LEAKS;
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("owner emplace valid no block alloc", "[emplace][owner]", owner_types) {
+    if constexpr (can_emplace_reusing_block<TestType> && !is_sealed<TestType>) {
+        volatile memory_tracker mem_track;
+
+        {
+            TestType ptr = make_pointer_deleter_1<TestType>();
+
+            // Only the allocation of the new object may succeed
+            allocations_before_forced_failure = 1u;
+            force_next_allocation_failure     = true;
+            ptr.emplace(test_object::state::special_init);
+            force_next_allocation_failure     = false;
+            allocations_before_forced_failure = 0u;
+
+            CHECK(ptr.get() != nullptr);
+            CHECK(ptr->state_ == test_object::state::special_init);
+            CHECK_INSTANCES(1, 1);
+        }
+
+        CHECK_NO_LEAKS;
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("owner emplace valid with observer", "[emplace][owner]", owner_types) {
+    if constexpr (can_use_make_observable<TestType>) {
+        volatile memory_tracker mem_track;
+
+        {
+            TestType               ptr = make_pointer_deleter_1<TestType>();
+            observer_ptr<TestType> optr{ptr};
+            ptr.emplace(test_object::state::special_init);
+
+            CHECK(optr.expired());
+            CHECK(ptr.get() != nullptr);
+            CHECK(ptr->state_ == test_object::state::special_init);
+            CHECK_INSTANCES(1, 1);
+
+            optr = ptr;
+            CHECK(optr.get() == ptr.get());
+        }
+
+        CHECK_NO_LEAKS;
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("owner emplace throw in constructor", "[emplace][owner]", owner_types) {
+    if constexpr (can_use_make_observable<TestType>) {
+        volatile memory_tracker mem_track;
+
+        {
+            TestType ptr          = make_pointer_deleter_1<TestType>();
+            auto*    raw_ptr_orig = ptr.get();
+
+            next_test_object_constructor_throws = true;
+            REQUIRE_THROWS_AS(ptr.emplace(), throw_constructor);
+
+            if constexpr (can_emplace_reusing_block<TestType> && is_sealed<TestType>) {
+                CHECK(ptr.get() == nullptr);
+                CHECK_INSTANCES(0, 1);
+            } else {
+                CHECK(ptr.get() == raw_ptr_orig);
+                CHECK_INSTANCES(1, 1);
+            }
+        }
+
+        CHECK_NO_LEAKS;
+    }
+}
+
+TEST_CASE("owner emplace copy of self", "[emplace][owner]") {
+    volatile memory_tracker mem_track;
+
+    {
+        const std::string value = "a string long enough to be allocated on the heap";
+
+        auto ptr = oup::make_observable_unique<std::string>(value);
+        ptr.emplace(*ptr);
+
+        CHECK(*ptr == value);
+    }
+
+    CHECK(mem_track.allocated() == 0u);
+    CHECK(mem_track.double_delete() == 0u);
+}
+
 TEMPLATE_LIST_TEST_CASE("owner swap empty vs empty", "[swap][owner]", owner_types) {
     volatile memory_tracker mem_track;
 
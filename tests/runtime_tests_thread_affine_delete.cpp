@@ -0,0 +1,122 @@
+#include "memory_tracker.hpp"
+#include "oup/thread_affine_delete.hpp"
+#include "testing.hpp"
+
+#include <thread>
+
+TEST_CASE("thread affine delete default", "[thread_affine][owner]") {
+    using TestType = oup::observable_unique_ptr<test_object, oup::thread_affine_delete>;
+    volatile memory_tracker mem_track;
+
+    {
+        TestType ptr(new test_object);
+        CHECK(ptr.get_deleter().queue == nullptr);
+
+        observer_ptr<TestType> optr{ptr};
+        ptr.reset();
+
+        CHECK(optr.expired());
+        CHECK_INSTANCES(0, 0);
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEST_CASE("thread affine delete on home thread", "[thread_affine][owner]") {
+    using TestType = oup::observable_unique_ptr<test_object, oup::thread_affine_delete>;
+    volatile memory_tracker mem_track;
+
+    {
+        oup::deferred_delete_queue queue;
+        CHECK(queue.on_home_thread());
+        CHECK(queue.home_thread() == std::this_thread::get_id());
+
+        TestType ptr = oup::make_observable_thread_affine<test_object>(
+            queue, test_object::state::special_init);
+        CHECK(ptr.get_deleter().queue == &queue);
+        CHECK(ptr->state_ == test_object::state::special_init);
+
+        observer_ptr<TestType> optr{ptr};
+        ptr.reset();
+
+        CHECK(optr.expired());
+        CHECK_INSTANCES(0, 0);
+        CHECK(queue.drain() == 0u);
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+#if !defined(OUP_PLATFORM_WASM)
+TEST_CASE("thread affine delete on foreign thread", "[thread_affine][owner]") {
+    using TestType = oup::observable_unique_ptr<test_object, oup::thread_affine_delete>;
+    volatile memory_tracker mem_track;
+
+    {
+        oup::deferred_delete_queue queue;
+
+        TestType               ptr = oup::make_observable_thread_affine<test_object>(queue);
+        observer_ptr<TestType> optr{ptr};
+
+        bool on_home_thread = true;
+        std::thread([&]() {
+            on_home_thread = queue.on_home_thread();
+            ptr.reset();
+        }).join();
+
+        CHECK(!on_home_thread);
+
+        CHECK(ptr.get() == nullptr);
+        CHECK(optr.expired());
+        CHECK_INSTANCES(1, 0);
+
+        CHECK(queue.drain() == 1u);
+        CHECK_INSTANCES(0, 0);
+        CHECK(queue.drain() == 0u);
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEST_CASE("thread affine delete bulk drain", "[thread_affine][owner]") {
+    using TestType = oup::observable_unique_ptr<test_object_derived, oup::thread_affine_delete>;
+    volatile memory_tracker mem_track;
+
+    {
+        oup::deferred_delete_queue queue;
+
+        TestType ptr1 = oup::make_observable_thread_affine<test_object_derived>(queue);
+        TestType ptr2 = oup::make_observable_thread_affine<test_object_derived>(queue);
+        TestType ptr3 = oup::make_observable_thread_affine<test_object_derived>(queue);
+
+        std::thread([&]() {
+            ptr1.reset();
+            ptr2.reset();
+        }).join();
+
+        std::thread([&]() { ptr3.reset(); }).join();
+
+        CHECK_INSTANCES_DERIVED(3, 3, 0);
+        CHECK(queue.drain() == 3u);
+        CHECK_INSTANCES_DERIVED(0, 0, 0);
+    }
+
+    CHECK_NO_LEAKS;
+}
+
+TEST_CASE("thread affine delete queue destructor", "[thread_affine][owner]") {
+    using TestType = oup::observable_unique_ptr<test_object, oup::thread_affine_delete>;
+    volatile memory_tracker mem_track;
+
+    {
+        oup::deferred_delete_queue queue;
+
+        TestType ptr = oup::make_observable_thread_affine<test_object>(queue);
+        std::thread([&]() { ptr.reset(); }).join();
+
+        CHECK_INSTANCES(1, 0);
+    }
+
+    CHECK_NO_LEAKS;
+}
+#endif
@@ -457,6 +457,11 @@ constexpr bool can_use_make_observable =
     (is_sealed<T> && std::is_same_v<get_deleter<T>, oup::placement_delete>) ||
     std::is_same_v<get_deleter<T>, oup::default_delete>;
 
+template<typename T>
+constexpr bool can_emplace_reusing_block =
+    can_use_make_observable<T> &&
+    (is_sealed<T> ? !has_eoft_multi_base<T> && !has_eoft_obs_member<T> : !has_eoft<T>);
+
 template<typename T>
 constexpr bool has_base = std::is_base_of_v<test_object_derived, std::remove_cv_t<get_object<T>>>;
 